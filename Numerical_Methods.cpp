@@ -2,12 +2,17 @@
 #include <cmath>
 #include <string>
 #include <vector>
+#include <map>
+#include <stdexcept>
 #include <algorithm>
 #include <limits>
 #include <fstream>
+#include <sstream>
 #include <chrono>
 #include <thread>
+#include <functional>
 #include <iomanip>
+#include <cstring>
 
 #ifdef _WIN32
 #include <conio.h>
@@ -16,9 +21,15 @@
 #include <unistd.h>
 #endif
 
+// Pauses between printed steps, turned off when running non-interactively
+bool animations_enabled = true;
+
 // Platform-specific functions
 #ifdef _WIN32
 void sleep_ms(int ms) {
+    if (!animations_enabled) {
+        return;
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 }
 
@@ -27,6 +38,9 @@ int getch() {
 }
 #else
 void sleep_ms(int ms) {
+    if (!animations_enabled) {
+        return;
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 }
 
@@ -47,154 +61,671 @@ int getch() {
 const double e = 2.718281828459045;
 const double pi = 3.141592653589793;
 
+// Built-in functions with their domain checks
+double checkedLog(double arg) {
+    if (arg <= 0) {
+        throw std::runtime_error("Invalid argument for logarithm");
+    }
+    return log(arg);
+}
+
+double checkedLog10(double arg) {
+    if (arg <= 0) {
+        throw std::runtime_error("Invalid argument for logarithm");
+    }
+    return log10(arg);
+}
+
+double checkedSqrt(double arg) {
+    if (arg < 0) {
+        throw std::runtime_error("Invalid argument for square root");
+    }
+    return sqrt(arg);
+}
+
+double builtinSin(double arg) { return sin(arg); }
+double builtinCos(double arg) { return cos(arg); }
+double builtinTan(double arg) { return tan(arg); }
+double builtinExp(double arg) { return exp(arg); }
+double builtinAbs(double arg) { return fabs(arg); }
+double builtinMin(double a, double b) { return std::min(a, b); }
+double builtinMax(double a, double b) { return std::max(a, b); }
+double builtinAtan2(double a, double b) { return atan2(a, b); }
+double builtinPow(double a, double b) { return pow(a, b); }
+double builtinHypot(double a, double b) { return hypot(a, b); }
+
+// Truncated Taylor series of a value: c[k] = f^(k) / k!, used for exact derivatives up to the third
+struct Jet {
+    double c[4];
+};
+
+Jet constantJet(double value) {
+    Jet result = {{value, 0, 0, 0}};
+    return result;
+}
+
+Jet mulJet(const Jet& a, const Jet& b) {
+    Jet result;
+    for (int k = 0; k < 4; k++) {
+        result.c[k] = 0;
+        for (int i = 0; i <= k; i++) {
+            result.c[k] += a.c[i] * b.c[k - i];
+        }
+    }
+    return result;
+}
+
+Jet divJet(const Jet& a, const Jet& b) {
+    if (b.c[0] == 0) {
+        throw std::runtime_error("Division by zero");
+    }
+    Jet result;
+    for (int k = 0; k < 4; k++) {
+        result.c[k] = a.c[k];
+        for (int i = 1; i <= k; i++) {
+            result.c[k] -= b.c[i] * result.c[k - i];
+        }
+        result.c[k] /= b.c[0];
+    }
+    return result;
+}
+
+// g(a) from the derivatives g, g', g'', g''' at the value of a
+Jet composeJet(const Jet& a, const double g[4]) {
+    Jet result;
+    result.c[0] = g[0];
+    result.c[1] = g[1] * a.c[1];
+    result.c[2] = g[1] * a.c[2] + 0.5 * g[2] * a.c[1] * a.c[1];
+    result.c[3] = g[1] * a.c[3] + g[2] * a.c[1] * a.c[2] + g[3] * a.c[1] * a.c[1] * a.c[1] / 6;
+    return result;
+}
+
+void jetSin(double a, double g[4]) {
+    double s = sin(a), c = cos(a);
+    g[0] = s; g[1] = c; g[2] = -s; g[3] = -c;
+}
+
+void jetCos(double a, double g[4]) {
+    double s = sin(a), c = cos(a);
+    g[0] = c; g[1] = -s; g[2] = -c; g[3] = s;
+}
+
+void jetTan(double a, double g[4]) {
+    double t = tan(a), sec2 = 1 + t * t;
+    g[0] = t; g[1] = sec2; g[2] = 2 * t * sec2; g[3] = 2 * sec2 * sec2 + 4 * t * t * sec2;
+}
+
+void jetExp(double a, double g[4]) {
+    g[0] = g[1] = g[2] = g[3] = exp(a);
+}
+
+void jetLog(double a, double g[4]) {
+    g[0] = checkedLog(a); g[1] = 1 / a; g[2] = -1 / (a * a); g[3] = 2 / (a * a * a);
+}
+
+void jetLog10(double a, double g[4]) {
+    double ln10 = log(10.0);
+    g[0] = checkedLog10(a); g[1] = 1 / (a * ln10); g[2] = -1 / (a * a * ln10); g[3] = 2 / (a * a * a * ln10);
+}
+
+void jetSqrt(double a, double g[4]) {
+    double r = checkedSqrt(a);
+    g[0] = r; g[1] = 0.5 / r; g[2] = -0.25 / (r * a); g[3] = 0.375 / (r * a * a);
+}
+
+void jetAbs(double a, double g[4]) {
+    g[0] = fabs(a); g[1] = (a < 0) ? -1 : 1; g[2] = 0; g[3] = 0;
+}
+
+Jet jetMin(const Jet& a, const Jet& b) {
+    return (a.c[0] <= b.c[0]) ? a : b;
+}
+
+Jet jetMax(const Jet& a, const Jet& b) {
+    return (a.c[0] >= b.c[0]) ? a : b;
+}
+
+Jet jetPow(const Jet& a, const Jet& b) {
+    double g[4];
+    if (b.c[1] == 0 && b.c[2] == 0 && b.c[3] == 0) {
+        // Constant exponent: d^k/da^k a^p = p (p - 1) ... a^(p - k)
+        double p = b.c[0], factor = 1;
+        for (int k = 0; k < 4; k++) {
+            g[k] = (factor == 0) ? 0 : factor * pow(a.c[0], p - k);
+            factor *= p - k;
+        }
+        return composeJet(a, g);
+    }
+
+    // Variable exponent: a^b = exp(b * log(a))
+    if (a.c[0] <= 0) {
+        throw std::runtime_error("Invalid base for power with variable exponent");
+    }
+    jetLog(a.c[0], g);
+    Jet exponent = mulJet(b, composeJet(a, g));
+    jetExp(exponent.c[0], g);
+    Jet result = composeJet(exponent, g);
+    result.c[0] = pow(a.c[0], b.c[0]);
+    return result;
+}
+
+Jet jetAtan2(const Jet& y, const Jet& x) {
+    // atan2 differs from atan(y / x) or -atan(x / y) only by a constant
+    bool use_x = (x.c[0] != 0);
+    Jet q = use_x ? divJet(y, x) : divJet(x, y);
+    double sign = use_x ? 1 : -1;
+    double d = 1 + q.c[0] * q.c[0];
+    double g[4] = {atan2(y.c[0], x.c[0]), sign / d, -sign * 2 * q.c[0] / (d * d),
+                   sign * (6 * q.c[0] * q.c[0] - 2) / (d * d * d)};
+    return composeJet(q, g);
+}
+
+Jet jetHypot(const Jet& a, const Jet& b) {
+    Jet sum = mulJet(a, a);
+    Jet b2 = mulJet(b, b);
+    for (int k = 0; k < 4; k++) {
+        sum.c[k] += b2.c[k];
+    }
+    double r = hypot(a.c[0], b.c[0]);
+    double g[4] = {r, 0.5 / r, -0.25 / (r * r * r), 0.375 / (r * r * r * r * r)};
+    return composeJet(sum, g);
+}
+
 // Function expression parser
+//
+// The expression is compiled once into a small stack-machine program. Names of
+// variables, constants and functions are resolved while compiling, so evaluating
+// the function only walks the instruction list and calls functions through pointers.
+//
+// Besides the expression itself, definitions can be given before it, separated by ';':
+//   k = 2.5                  named constant
+//   sq(u) = u*u              user-defined helper function
+//   sq(x) - k                the function f(x) itself (always last)
 class ExpressionParser {
 private:
+    enum Opcode {
+        PushConst, PushX, PushT, LoadLocal, StoreLocal,
+        Add, Sub, Mul, Div, Pow, Neg,
+        Call1, Call2,
+        Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual,
+        JumpIfFalse, Jump
+    };
+
+    struct Instruction {
+        Opcode op;
+        double value;
+        int index;
+        double (*fn1)(double);
+        double (*fn2)(double, double);
+        void (*jet1)(double, double[4]);
+        Jet (*jet2)(const Jet&, const Jet&);
+    };
+
+    struct BuiltinFunction {
+        const char* name;
+        int arity;
+        double (*fn1)(double);
+        double (*fn2)(double, double);
+        void (*jet1)(double, double[4]);
+        Jet (*jet2)(const Jet&, const Jet&);
+    };
+
+    struct UserFunction {
+        std::vector<std::string> params;
+        std::string body;
+    };
+
     std::string expression;
     size_t position;
 
-    double parseExpression();
-    double parseTerm();
-    double parseFactor();
-    double parseFunction();
-    double parseNumber();
+    std::vector<Instruction> code;
+    std::map<std::string, double> constants;
+    std::map<std::string, UserFunction> functions;
+    std::vector<std::map<std::string, int> > scopes;
+    std::vector<std::string> expanding;
+    int depth, max_depth, local_count, max_locals;
+    size_t fold_barrier;
+    bool uses_variables;
+
+    static const BuiltinFunction builtins[];
+
+    void compileStatement(const std::string& statement);
+    void parseComparison();
+    void parseExpression();
+    void parseTerm();
+    void parseFactor();
+    void parseFunction();
+    void parseNumber();
+    void parseUserCall(const std::string& name, const UserFunction& function);
+    std::string parseIdentifier();
+    void expect(char c, const std::string& message);
+
+    void emit(Opcode op, double value = 0, int index = 0);
+    void emitCall(const BuiltinFunction& function);
+    bool isReserved(const std::string& name) const;
+    double run(const std::vector<Instruction>& program, double x, double t) const;
+    void runJet(const std::vector<Instruction>& program, double x, double t, Jet& result) const;
 
 public:
-    ExpressionParser(const std::string& expr) : expression(expr), position(0) {
-        // Remove spaces from the expression
-        expression.erase(remove_if(expression.begin(), expression.end(), isspace), expression.end());
-    }
+    ExpressionParser(const std::string& expr);
 
-    double evaluate(double x);
-    double evaluateDerivative(double x, double h = 0.0001);
+    double evaluate(double x) const;
+    double evaluate(double x, double t) const;
+    double evaluateDerivative(double x, double h = 0.0001) const;
+    void evaluateWithDerivatives(double x, double derivatives[4]) const;
+    double evaluateDerivativeX(double x, double t, double h = 0.0001) const;
+    double evaluateDerivativeT(double x, double t, double h = 0.0001) const;
 };
 
-double ExpressionParser::parseExpression() {
-    double result = parseTerm();
+const ExpressionParser::BuiltinFunction ExpressionParser::builtins[] = {
+    {"sin", 1, builtinSin, nullptr, jetSin, nullptr},
+    {"cos", 1, builtinCos, nullptr, jetCos, nullptr},
+    {"tan", 1, builtinTan, nullptr, jetTan, nullptr},
+    {"exp", 1, builtinExp, nullptr, jetExp, nullptr},
+    {"log", 1, checkedLog, nullptr, jetLog, nullptr},
+    {"ln", 1, checkedLog, nullptr, jetLog, nullptr},
+    {"log10", 1, checkedLog10, nullptr, jetLog10, nullptr},
+    {"sqrt", 1, checkedSqrt, nullptr, jetSqrt, nullptr},
+    {"abs", 1, builtinAbs, nullptr, jetAbs, nullptr},
+    {"min", 2, nullptr, builtinMin, nullptr, jetMin},
+    {"max", 2, nullptr, builtinMax, nullptr, jetMax},
+    {"atan2", 2, nullptr, builtinAtan2, nullptr, jetAtan2},
+    {"pow", 2, nullptr, builtinPow, nullptr, jetPow},
+    {"hypot", 2, nullptr, builtinHypot, nullptr, jetHypot},
+    {nullptr, 0, nullptr, nullptr, nullptr, nullptr}
+};
+
+ExpressionParser::ExpressionParser(const std::string& expr)
+    : expression(expr), position(0), depth(0), max_depth(0), local_count(0), max_locals(0), fold_barrier(0), uses_variables(false) {
+    // Remove spaces from the expression
+    expression.erase(remove_if(expression.begin(), expression.end(), isspace), expression.end());
+
+    // Definitions come first, the function itself is the last statement
+    std::string source = expression;
+    std::vector<std::string> statements;
+    size_t start = 0, end;
+    while ((end = source.find(';', start)) != std::string::npos) {
+        statements.push_back(source.substr(start, end - start));
+        start = end + 1;
+    }
+    statements.push_back(source.substr(start));
+    while (statements.size() > 1 && statements.back().empty()) {
+        statements.pop_back();
+    }
+
+    for (size_t i = 0; i + 1 < statements.size(); i++) {
+        if (!statements[i].empty()) {
+            compileStatement(statements[i]);
+        }
+    }
+
+    expression = statements.back();
+    position = 0;
+    code.clear();
+    depth = max_depth = 0;
+    local_count = max_locals = 0;
+    fold_barrier = 0;
+    parseComparison();
+    if (position != expression.size()) {
+        throw std::runtime_error("Unexpected character '" + std::string(1, expression[position]) + "'");
+    }
+}
+
+void ExpressionParser::compileStatement(const std::string& statement) {
+    expression = statement;
+    position = 0;
+    std::string name = parseIdentifier();
+    if (name.empty()) {
+        throw std::runtime_error("Expected a name at the start of a definition");
+    }
+    if (isReserved(name)) {
+        throw std::runtime_error("Cannot redefine '" + name + "'");
+    }
+
+    if (position < expression.size() && expression[position] == '(') {
+        // Helper function: name(a,b,...) = body
+        UserFunction function;
+        position++;
+        while (true) {
+            std::string param = parseIdentifier();
+            if (param.empty()) {
+                throw std::runtime_error("Expected a parameter name in definition of " + name);
+            }
+            if (std::find(function.params.begin(), function.params.end(), param) != function.params.end()) {
+                throw std::runtime_error("Duplicate parameter '" + param + "' in definition of " + name);
+            }
+            function.params.push_back(param);
+            if (position < expression.size() && expression[position] == ',') {
+                position++;
+                continue;
+            }
+            break;
+        }
+        expect(')', "Missing closing parenthesis after parameters of " + name);
+        expect('=', "Missing '=' in definition of " + name);
+        function.body = expression.substr(position);
+
+        // Compile the body once so syntax errors are reported at definition time
+        std::vector<Instruction> saved;
+        saved.swap(code);
+        fold_barrier = 0;
+        int saved_locals = local_count, saved_max_locals = max_locals;
+        std::map<std::string, int> scope;
+        for (size_t i = 0; i < function.params.size(); i++) {
+            scope[function.params[i]] = local_count++;
+        }
+        scopes.push_back(scope);
+        expanding.push_back(name);
+        parseComparison();
+        expanding.pop_back();
+        scopes.pop_back();
+        code.swap(saved);
+        local_count = saved_locals;
+        max_locals = saved_max_locals;
+        if (position != expression.size()) {
+            throw std::runtime_error("Unexpected character in definition of " + name);
+        }
+        functions[name] = function;
+    } else {
+        // Named constant: name = value, evaluated now
+        expect('=', "Missing '=' in definition of " + name);
+        std::vector<Instruction> saved;
+        saved.swap(code);
+        fold_barrier = 0;
+        uses_variables = false;
+        depth = 0;
+        parseComparison();
+        std::vector<Instruction> program;
+        program.swap(code);
+        code.swap(saved);
+        if (position != expression.size()) {
+            throw std::runtime_error("Unexpected character in definition of " + name);
+        }
+        if (uses_variables) {
+            throw std::runtime_error("Constant " + name + " cannot depend on x or t");
+        }
+        constants[name] = run(program, 0, 0);
+    }
+}
+
+bool ExpressionParser::isReserved(const std::string& name) const {
+    if (name == "x" || name == "t" || name == "e" || name == "pi" || name == "if") {
+        return true;
+    }
+    for (const BuiltinFunction* b = builtins; b->name; b++) {
+        if (name == b->name) {
+            return true;
+        }
+    }
+    return constants.count(name) > 0 || functions.count(name) > 0;
+}
+
+std::string ExpressionParser::parseIdentifier() {
+    std::string name;
+    if (position < expression.size() && isalpha(expression[position])) {
+        while (position < expression.size() && (isalnum(expression[position]) || expression[position] == '_')) {
+            name += expression[position++];
+        }
+    }
+    return name;
+}
+
+void ExpressionParser::expect(char c, const std::string& message) {
+    if (position >= expression.size() || expression[position] != c) {
+        throw std::runtime_error(message);
+    }
+    position++;
+}
+
+void ExpressionParser::emit(Opcode op, double value, int index) {
+    Instruction ins = {op, value, index, nullptr, nullptr, nullptr, nullptr};
+
+    // Fold arithmetic on two constants into a single constant
+    size_t n = code.size();
+    bool binary = (op == Add || op == Sub || op == Mul || op == Div || op == Pow);
+    if (binary && n >= 2 && n - 2 >= fold_barrier && code[n - 2].op == PushConst && code[n - 1].op == PushConst) {
+        double a = code[n - 2].value, b = code[n - 1].value;
+        if (op != Div || b != 0) {
+            double result = (op == Add) ? a + b : (op == Sub) ? a - b : (op == Mul) ? a * b : (op == Div) ? a / b : pow(a, b);
+            code.pop_back();
+            code.back().value = result;
+            depth--;
+            return;
+        }
+    }
+    if (op == Neg && n >= 1 && n - 1 >= fold_barrier && code[n - 1].op == PushConst) {
+        code.back().value = -code.back().value;
+        return;
+    }
+
+    code.push_back(ins);
+    switch (op) {
+        case PushConst: case PushX: case PushT: case LoadLocal:
+            depth++;
+            break;
+        case Neg: case Call1: case Jump:
+            break;
+        default:
+            depth--;
+            break;
+    }
+    max_depth = std::max(max_depth, depth);
+}
+
+void ExpressionParser::emitCall(const BuiltinFunction& function) {
+    Instruction ins = {function.arity == 1 ? Call1 : Call2, 0, 0, function.fn1, function.fn2, function.jet1, function.jet2};
+    code.push_back(ins);
+    if (function.arity == 2) {
+        depth--;
+    }
+}
+
+void ExpressionParser::parseComparison() {
+    parseExpression();
+
+    if (position < expression.size()) {
+        char c = expression[position];
+        char next = (position + 1 < expression.size()) ? expression[position + 1] : '\0';
+        Opcode op;
+        if (c == '<' && next == '=') {
+            op = LessEqual;
+        } else if (c == '>' && next == '=') {
+            op = GreaterEqual;
+        } else if (c == '=' && next == '=') {
+            op = Equal;
+        } else if (c == '!' && next == '=') {
+            op = NotEqual;
+        } else if (c == '<') {
+            op = Less;
+        } else if (c == '>') {
+            op = Greater;
+        } else {
+            return;
+        }
+        position += (next == '=') ? 2 : 1;
+        parseExpression();
+        emit(op);
+    }
+}
+
+void ExpressionParser::parseExpression() {
+    parseTerm();
 
     while (position < expression.size()) {
         if (expression[position] == '+') {
             position++;
-            result += parseTerm();
+            parseTerm();
+            emit(Add);
         } else if (expression[position] == '-') {
             position++;
-            result -= parseTerm();
+            parseTerm();
+            emit(Sub);
         } else {
             break;
         }
     }
-
-    return result;
 }
 
-double ExpressionParser::parseTerm() {
-    double result = parseFactor();
+void ExpressionParser::parseTerm() {
+    parseFactor();
 
     while (position < expression.size()) {
         if (expression[position] == '*') {
             position++;
-            result *= parseFactor();
+            parseFactor();
+            emit(Mul);
         } else if (expression[position] == '/') {
             position++;
-            double divisor = parseFactor();
-            if (divisor == 0) {
-                throw std::runtime_error("Division by zero");
-            }
-            result /= divisor;
+            parseFactor();
+            emit(Div);
         } else {
             break;
         }
     }
-
-    return result;
 }
 
-double ExpressionParser::parseFactor() {
-    double result;
+void ExpressionParser::parseFactor() {
+    if (position >= expression.size()) {
+        throw std::runtime_error("Unexpected end of expression");
+    }
 
     if (expression[position] == '(') {
         position++;
-        result = parseExpression();
-        if (position >= expression.size() || expression[position] != ')') {
-            throw std::runtime_error("Missing closing parenthesis");
-        }
-        position++;
+        parseComparison();
+        expect(')', "Missing closing parenthesis");
     } else if (isalpha(expression[position])) {
-        result = parseFunction();
+        parseFunction();
+    } else if (expression[position] == '-') {
+        // Unary minus binds looser than '^', so -2^2 is -(2^2)
+        position++;
+        parseFactor();
+        emit(Neg);
+        return;
     } else {
-        result = parseNumber();
+        parseNumber();
     }
 
     // Handle exponentiation
     if (position < expression.size() && expression[position] == '^') {
         position++;
-        double exponent = parseFactor();
-        result = pow(result, exponent);
+        parseFactor();
+        emit(Pow);
     }
-
-    return result;
 }
 
-double ExpressionParser::parseFunction() {
-    std::string function;
-    while (position < expression.size() && isalpha(expression[position])) {
-        function += expression[position++];
+void ExpressionParser::parseFunction() {
+    std::string function = parseIdentifier();
+    bool call = position < expression.size() && expression[position] == '(';
+
+    if (!call) {
+        if (!scopes.empty() && scopes.back().count(function)) {
+            emit(LoadLocal, 0, scopes.back()[function]);
+        } else if (function == "x") {
+            uses_variables = true;
+            emit(PushX);
+        } else if (function == "t") {
+            uses_variables = true;
+            emit(PushT);
+        } else if (constants.count(function)) {
+            emit(PushConst, constants[function]);
+        } else if (function == "e") {
+            emit(PushConst, e);
+        } else if (function == "pi") {
+            emit(PushConst, pi);
+        } else {
+            throw std::runtime_error("Unknown variable or constant: " + function);
+        }
+        return;
     }
+    position++;
 
-    if (function == "x") {
-        return 0; // Placeholder for variable x, will be replaced during evaluation
+    if (function == "if") {
+        // if(cond, a, b) only evaluates the branch that is taken
+        parseComparison();
+        expect(',', "if() needs three arguments");
+        size_t jump_if_false = code.size();
+        emit(JumpIfFalse);
+        int branch_depth = depth;
+        parseComparison();
+        expect(',', "if() needs three arguments");
+        size_t jump = code.size();
+        emit(Jump);
+        code[jump_if_false].index = (int)code.size();
+        depth = branch_depth;
+        parseComparison();
+        expect(')', "Missing closing parenthesis after if() arguments");
+        code[jump].index = (int)code.size();
+        fold_barrier = code.size();
+        return;
     }
 
-    if (position >= expression.size() || expression[position] != '(') {
-        throw std::runtime_error("Missing opening parenthesis after function name");
+    std::map<std::string, UserFunction>::const_iterator user = functions.find(function);
+    if (user != functions.end()) {
+        parseUserCall(function, user->second);
+        return;
     }
-    position++;
 
-    double arg = parseExpression();
+    for (const BuiltinFunction* b = builtins; b->name; b++) {
+        if (function == b->name) {
+            parseComparison();
+            if (b->arity == 2) {
+                expect(',', function + "() needs two arguments");
+                parseComparison();
+            }
+            expect(')', "Missing closing parenthesis after function argument");
+            emitCall(*b);
+            return;
+        }
+    }
 
-    if (position >= expression.size() || expression[position] != ')') {
-        throw std::runtime_error("Missing closing parenthesis after function argument");
+    if (std::find(expanding.begin(), expanding.end(), function) != expanding.end()) {
+        throw std::runtime_error("Recursive function: " + function);
     }
-    position++;
+    throw std::runtime_error("Unknown function: " + function);
+}
 
-    if (function == "sin") {
-        return sin(arg);
-    } else if (function == "cos") {
-        return cos(arg);
-    } else if (function == "tan") {
-        return tan(arg);
-    } else if (function == "exp") {
-        return exp(arg);
-    } else if (function == "log" || function == "ln") {
-        if (arg <= 0) {
-            throw std::runtime_error("Invalid argument for logarithm");
-        }
-        return log(arg);
-    } else if (function == "log10") {
-        if (arg <= 0) {
-            throw std::runtime_error("Invalid argument for logarithm");
-        }
-        return log10(arg);
-    } else if (function == "sqrt") {
-        if (arg < 0) {
-            throw std::runtime_error("Invalid argument for square root");
-        }
-        return sqrt(arg);
-    } else if (function == "abs") {
-        return fabs(arg);
-    } else {
-        throw std::runtime_error("Unknown function: " + function);
+void ExpressionParser::parseUserCall(const std::string& name, const UserFunction& function) {
+    if (std::find(expanding.begin(), expanding.end(), name) != expanding.end()) {
+        throw std::runtime_error("Recursive function: " + name);
+    }
+
+    // Arguments are stored in local slots reserved for this call site
+    int base = local_count;
+    local_count += (int)function.params.size();
+    max_locals = std::max(max_locals, local_count);
+    for (size_t i = 0; i < function.params.size(); i++) {
+        if (i > 0) {
+            expect(',', "Wrong number of arguments for " + name);
+        }
+        parseComparison();
+        emit(StoreLocal, 0, base + (int)i);
+    }
+    expect(')', "Wrong number of arguments for " + name);
+
+    // Inline the body with its parameters bound to the slots
+    std::string saved_expression = expression;
+    size_t saved_position = position;
+    std::map<std::string, int> scope;
+    for (size_t i = 0; i < function.params.size(); i++) {
+        scope[function.params[i]] = base + (int)i;
     }
+    expression = function.body;
+    position = 0;
+    scopes.push_back(scope);
+    expanding.push_back(name);
+    parseComparison();
+    expanding.pop_back();
+    scopes.pop_back();
+    expression = saved_expression;
+    position = saved_position;
+
+    // The slots are free again once the call has been inlined
+    local_count = base;
 }
 
-double ExpressionParser::parseNumber() {
+void ExpressionParser::parseNumber() {
     size_t start = position;
     
-    // Handle negative numbers
-    if (expression[position] == '-') {
-        position++;
-    }
-    
     // Parse digits before decimal point
     while (position < expression.size() && isdigit(expression[position])) {
         position++;
@@ -212,47 +743,143 @@ double ExpressionParser::parseNumber() {
         throw std::runtime_error("Invalid number");
     }
     
-    return std::stod(expression.substr(start, position - start));
+    emit(PushConst, std::stod(expression.substr(start, position - start)));
 }
 
-double ExpressionParser::evaluate(double x) {
-    // Replace x in the expression with the provided value
-    std::string expr_copy = expression;
-    size_t pos = 0;
-    
-    position = 0; // Reset position for parsing
-    
-    // Replace standalone 'x' variables
-    while ((pos = expr_copy.find("x", pos)) != std::string::npos) {
-        // Check if 'x' is a standalone variable and not part of a function name or another identifier
-        bool standalone = true;
-        if (pos > 0 && (isalpha(expr_copy[pos-1]) || isdigit(expr_copy[pos-1]))) {
-            standalone = false;
-        }
-        if (pos < expr_copy.length() - 1 && (isalpha(expr_copy[pos+1]) || isdigit(expr_copy[pos+1]))) {
-            standalone = false;
+double ExpressionParser::run(const std::vector<Instruction>& program, double x, double t) const {
+    // Stack and local slots live on the C++ stack unless the program is unusually large
+    double buffer[64];
+    std::vector<double> heap;
+    double* stack = buffer;
+    size_t needed = (size_t)max_depth + max_locals + 1;
+    if (needed > 64) {
+        heap.resize(needed);
+        stack = &heap[0];
+    }
+    double* locals = stack + max_depth + 1;
+    int sp = -1;
+
+    for (size_t pc = 0; pc < program.size(); pc++) {
+        const Instruction& ins = program[pc];
+        switch (ins.op) {
+            case PushConst: stack[++sp] = ins.value; break;
+            case PushX: stack[++sp] = x; break;
+            case PushT: stack[++sp] = t; break;
+            case LoadLocal: stack[++sp] = locals[ins.index]; break;
+            case StoreLocal: locals[ins.index] = stack[sp--]; break;
+            case Add: sp--; stack[sp] += stack[sp + 1]; break;
+            case Sub: sp--; stack[sp] -= stack[sp + 1]; break;
+            case Mul: sp--; stack[sp] *= stack[sp + 1]; break;
+            case Div:
+                sp--;
+                if (stack[sp + 1] == 0) {
+                    throw std::runtime_error("Division by zero");
+                }
+                stack[sp] /= stack[sp + 1];
+                break;
+            case Pow: sp--; stack[sp] = pow(stack[sp], stack[sp + 1]); break;
+            case Neg: stack[sp] = -stack[sp]; break;
+            case Call1: stack[sp] = ins.fn1(stack[sp]); break;
+            case Call2: sp--; stack[sp] = ins.fn2(stack[sp], stack[sp + 1]); break;
+            case Less: sp--; stack[sp] = stack[sp] < stack[sp + 1] ? 1 : 0; break;
+            case LessEqual: sp--; stack[sp] = stack[sp] <= stack[sp + 1] ? 1 : 0; break;
+            case Greater: sp--; stack[sp] = stack[sp] > stack[sp + 1] ? 1 : 0; break;
+            case GreaterEqual: sp--; stack[sp] = stack[sp] >= stack[sp + 1] ? 1 : 0; break;
+            case Equal: sp--; stack[sp] = stack[sp] == stack[sp + 1] ? 1 : 0; break;
+            case NotEqual: sp--; stack[sp] = stack[sp] != stack[sp + 1] ? 1 : 0; break;
+            case JumpIfFalse:
+                if (stack[sp--] == 0) {
+                    pc = ins.index - 1;
+                }
+                break;
+            case Jump: pc = ins.index - 1; break;
         }
-        
-        if (standalone) {
-            std::string x_value = std::to_string(x);
-            expr_copy.replace(pos, 1, x_value);
-            pos += x_value.length();
-        } else {
-            pos++;
+    }
+
+    return stack[sp];
+}
+
+void ExpressionParser::runJet(const std::vector<Instruction>& program, double x, double t, Jet& result) const {
+    // Same program as run(), on truncated Taylor series in x instead of plain values
+    Jet buffer[64];
+    std::vector<Jet> heap;
+    Jet* stack = buffer;
+    size_t needed = (size_t)max_depth + max_locals + 1;
+    if (needed > 64) {
+        heap.resize(needed);
+        stack = &heap[0];
+    }
+    Jet* locals = stack + max_depth + 1;
+    int sp = -1;
+    double g[4];
+
+    for (size_t pc = 0; pc < program.size(); pc++) {
+        const Instruction& ins = program[pc];
+        switch (ins.op) {
+            case PushConst: stack[++sp] = constantJet(ins.value); break;
+            case PushX: stack[++sp] = constantJet(x); stack[sp].c[1] = 1; break;
+            case PushT: stack[++sp] = constantJet(t); break;
+            case LoadLocal: stack[++sp] = locals[ins.index]; break;
+            case StoreLocal: locals[ins.index] = stack[sp--]; break;
+            case Add: sp--; for (int k = 0; k < 4; k++) stack[sp].c[k] += stack[sp + 1].c[k]; break;
+            case Sub: sp--; for (int k = 0; k < 4; k++) stack[sp].c[k] -= stack[sp + 1].c[k]; break;
+            case Mul: sp--; stack[sp] = mulJet(stack[sp], stack[sp + 1]); break;
+            case Div: sp--; stack[sp] = divJet(stack[sp], stack[sp + 1]); break;
+            case Pow: sp--; stack[sp] = jetPow(stack[sp], stack[sp + 1]); break;
+            case Neg: for (int k = 0; k < 4; k++) stack[sp].c[k] = -stack[sp].c[k]; break;
+            case Call1: ins.jet1(stack[sp].c[0], g); stack[sp] = composeJet(stack[sp], g); break;
+            case Call2: sp--; stack[sp] = ins.jet2(stack[sp], stack[sp + 1]); break;
+            case Less: sp--; stack[sp] = constantJet(stack[sp].c[0] < stack[sp + 1].c[0] ? 1 : 0); break;
+            case LessEqual: sp--; stack[sp] = constantJet(stack[sp].c[0] <= stack[sp + 1].c[0] ? 1 : 0); break;
+            case Greater: sp--; stack[sp] = constantJet(stack[sp].c[0] > stack[sp + 1].c[0] ? 1 : 0); break;
+            case GreaterEqual: sp--; stack[sp] = constantJet(stack[sp].c[0] >= stack[sp + 1].c[0] ? 1 : 0); break;
+            case Equal: sp--; stack[sp] = constantJet(stack[sp].c[0] == stack[sp + 1].c[0] ? 1 : 0); break;
+            case NotEqual: sp--; stack[sp] = constantJet(stack[sp].c[0] != stack[sp + 1].c[0] ? 1 : 0); break;
+            case JumpIfFalse:
+                if (stack[sp--].c[0] == 0) {
+                    pc = ins.index - 1;
+                }
+                break;
+            case Jump: pc = ins.index - 1; break;
         }
     }
-    
-    expression = expr_copy;
-    double result = parseExpression();
-    expression = expr_copy; // Restore original expression
-    return result;
+
+    result = stack[sp];
+}
+
+double ExpressionParser::evaluate(double x) const {
+    return run(code, x, 0);
 }
 
-double ExpressionParser::evaluateDerivative(double x, double h) {
+double ExpressionParser::evaluate(double x, double t) const {
+    return run(code, x, t);
+}
+
+double ExpressionParser::evaluateDerivative(double x, double h) const {
     // Numerical derivative using central difference
     return (evaluate(x + h) - evaluate(x - h)) / (2 * h);
 }
 
+void ExpressionParser::evaluateWithDerivatives(double x, double derivatives[4]) const {
+    // The function and its first three derivatives in one pass, exact up to rounding
+    Jet result;
+    runJet(code, x, 0, result);
+    derivatives[0] = result.c[0];
+    derivatives[1] = result.c[1];
+    derivatives[2] = 2 * result.c[2];
+    derivatives[3] = 6 * result.c[3];
+}
+
+double ExpressionParser::evaluateDerivativeX(double x, double t, double h) const {
+    // Partial derivative with respect to x using central difference
+    return (evaluate(x + h, t) - evaluate(x - h, t)) / (2 * h);
+}
+
+double ExpressionParser::evaluateDerivativeT(double x, double t, double h) const {
+    // Partial derivative with respect to t using central difference
+    return (evaluate(x, t + h) - evaluate(x, t - h)) / (2 * h);
+}
+
 // Function manager to handle user-defined functions
 class FunctionManager {
 private:
@@ -274,17 +901,28 @@ public:
             return false;
         }
         
-        std::getline(file, expression);
+        // Definitions may be given on separate lines before the function itself
+        expression.clear();
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos || line[line.find_first_not_of(" \t")] == '#') {
+                continue;
+            }
+            if (!expression.empty()) {
+                expression += "; ";
+            }
+            expression += line;
+        }
         file.close();
         
         if (parser) {
             delete parser;
+            parser = nullptr;
         }
         
         try {
+            // Syntax errors are reported while compiling; domain errors only when evaluating
             parser = new ExpressionParser(expression);
-            // Test the parser with a simple value to catch basic syntax errors
-            parser->evaluate(1.0);
             return true;
         } catch (const std::exception& e) {
             std::cerr << "Error parsing function: " << e.what() << std::endl;
@@ -299,12 +937,12 @@ public:
         
         if (parser) {
             delete parser;
+            parser = nullptr;
         }
         
         try {
+            // Syntax errors are reported while compiling; domain errors only when evaluating
             parser = new ExpressionParser(expression);
-            // Test the parser with a simple value to catch basic syntax errors
-            parser->evaluate(1.0);
             return true;
         } catch (const std::exception& e) {
             std::cerr << "Error parsing function: " << e.what() << std::endl;
@@ -328,6 +966,34 @@ public:
         return parser->evaluateDerivative(x, h);
     }
     
+    void evaluateWithDerivatives(double x, double derivatives[4]) {
+        if (!parser) {
+            throw std::runtime_error("No function defined");
+        }
+        parser->evaluateWithDerivatives(x, derivatives);
+    }
+    
+    double evaluate(double x, double t) {
+        if (!parser) {
+            throw std::runtime_error("No function defined");
+        }
+        return parser->evaluate(x, t);
+    }
+    
+    double evaluateDerivativeX(double x, double t, double h = 0.0001) {
+        if (!parser) {
+            throw std::runtime_error("No function defined");
+        }
+        return parser->evaluateDerivativeX(x, t, h);
+    }
+    
+    double evaluateDerivativeT(double x, double t, double h = 0.0001) {
+        if (!parser) {
+            throw std::runtime_error("No function defined");
+        }
+        return parser->evaluateDerivativeT(x, t, h);
+    }
+    
     std::string getExpression() const {
         return expression;
     }
@@ -340,6 +1006,7 @@ class RegulaFalsi {
     FunctionManager& func;
     double tolerance;
     int max_iterations;
+    int iterations = 0;
 
 public: 
     RegulaFalsi(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
@@ -363,13 +1030,15 @@ public:
             std::cout << "c = " << std::fixed << std::setprecision(4) << c 
                       << "\t f(c) = " << std::fixed << std::setprecision(4) << y_c << std::endl;
 
-            if (y_c >= tolerance) {
+            // Keep the root bracketed whichever way the function slopes
+            if (y_c * func.evaluate(a) < 0) {
                 b = c;
-            } else if (y_c <= -tolerance) {
+            } else {
                 a = c;
             }
         } 
 
+        iterations = count;
         std::cout << std::endl << "Number of Iterations = " << count << std::endl;
         if (count >= max_iterations) {
             std::cout << "Maximum iterations reached, solution may not be accurate." << std::endl;
@@ -377,6 +1046,14 @@ public:
         std::cout << "By Regula Falsi Method, c = " << std::fixed << std::setprecision(4) << c << " (approximately)";
     }
     
+    double getRoot() const {
+        return c;
+    }
+    
+    int getIterations() const {
+        return iterations;
+    }
+    
 private:
     void findBracket() {
         // Ask user for search range
@@ -430,6 +1107,7 @@ class SecantMethod {
     FunctionManager& func;
     double tolerance;
     int max_iterations;
+    int iterations = 0;
 
 public: 
     SecantMethod(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
@@ -476,12 +1154,21 @@ public:
             }
         } 
 
+        iterations = count;
         std::cout << std::endl << "Number of Iterations = " << count << std::endl;
         if (count >= max_iterations) {
             std::cout << "Maximum iterations reached, solution may not be accurate." << std::endl;
         }
         std::cout << "By Secant Method, x" << count << " = " << std::fixed << std::setprecision(4) << c << " (approximately)";
     }
+    
+    double getRoot() const {
+        return c;
+    }
+    
+    int getIterations() const {
+        return iterations;
+    }
 };
 
 class NewtonRaphson {
@@ -490,6 +1177,7 @@ class NewtonRaphson {
     FunctionManager& func;
     double tolerance;
     int max_iterations;
+    int iterations = 0;
 
 public: 
     NewtonRaphson(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
@@ -531,6 +1219,7 @@ public:
             }
         }
 
+        iterations = count;
         // Printing the Final Answer
         std::cout << std::endl << "Number of Iterations = " << count;
         if (count >= max_iterations) {
@@ -538,6 +1227,14 @@ public:
         }
         std::cout << std::endl << "Answer is " << std::fixed << std::setprecision(4) << x2;
     }
+    
+    double getRoot() const {
+        return x2;
+    }
+    
+    int getIterations() const {
+        return iterations;
+    }
 };
 
 class MullersMethod {
@@ -546,6 +1243,7 @@ class MullersMethod {
     FunctionManager& func;
     double tolerance;
     int max_iterations;
+    int iterations = 0;
 
 public: 
     MullersMethod(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
@@ -594,14 +1292,14 @@ public:
                     discriminant = std::abs(discriminant);
                 }
 
-                // Choose the denominator that gives the smaller absolute value
+                // Choose the denominator with the larger absolute value, giving the smaller step
                 double denominator1 = B + std::sqrt(discriminant);
                 double denominator2 = B - std::sqrt(discriminant);
                 
-                if (std::abs(denominator1) >= std::abs(denominator2) && std::abs(denominator2) > 1e-10) {
-                    x3 = x0 - ((2*y0) / denominator2);
-                } else if (std::abs(denominator1) > 1e-10) {
+                if (std::abs(denominator1) >= std::abs(denominator2) && std::abs(denominator1) > 1e-10) {
                     x3 = x0 - ((2*y0) / denominator1);
+                } else if (std::abs(denominator2) > 1e-10) {
+                    x3 = x0 - ((2*y0) / denominator2);
                 } else {
                     std::cout << "Division by near-zero value. Method failed to converge." << std::endl;
                     break;
@@ -625,6 +1323,7 @@ public:
             }
         }
 
+        iterations = count;
         sleep_ms(500);
         std::cout << std::endl << "By Muller's Method," << std::endl;
         if (count >= max_iterations) {
@@ -632,21 +1331,1091 @@ public:
         }
         std::cout << "x(i+1) = " << std::fixed << std::setprecision(4) << x3 << " (approximately)";
     }
+    
+    double getRoot() const {
+        return x3;
+    }
+    
+    int getIterations() const {
+        return iterations;
+    }
 };
 
-// Display a stylish ASCII art banner
-void displayBanner() {
-    std::cout << "\n";
-    std::cout << " ╔════════════════════════════════════════════════════════════════╗\n";
-    std::cout << " ║                                                                ║\n";
-    std::cout << " ║  ███╗   ██╗██╗   ██╗███╗   ███╗███████╗██████╗ ██╗ ██████╗    ║\n";
-    std::cout << " ║  ████╗  ██║██║   ██║████╗ ████║██╔════╝██╔══██╗██║██╔════╝    ║\n";
-    std::cout << " ║  ██╔██╗ ██║██║   ██║██╔████╔██║█████╗  ██████╔╝██║██║         ║\n";
-    std::cout << " ║  ██║╚██╗██║██║   ██║██║╚██╔╝██║██╔══╝  ██╔══██╗██║██║         ║\n";
-    std::cout << " ║  ██║ ╚████║╚██████╔╝██║ ╚═╝ ██║███████╗██║  ██║██║╚██████╗    ║\n";
-    std::cout << " ║  ╚═╝  ╚═══╝ ╚═════╝ ╚═╝     ╚═╝╚══════╝╚═╝  ╚═╝╚═╝ ╚═════╝    ║\n";
-    std::cout << " ║                                                                ║\n";
-    std::cout << " ║              METHODS CALCULATOR                               ║\n";
+class SteffensenMethod {
+    double x1, x2;
+    double y_x = std::numeric_limits<double>::max();
+    FunctionManager& func;
+    double tolerance;
+    int max_iterations;
+
+public: 
+    SteffensenMethod(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
+        : func(f), tolerance(tol), max_iterations(max_iter) {
+        
+        sleep_ms(500);
+        std::cout << std::endl << "Enter the first approximate value: ";
+        std::cin >> x1;
+        x2 = x1;
+
+        int count = 0;
+        bool evaluated = true;
+        try {
+            y_x = func.evaluate(x1);
+        } catch (const std::exception& e) {
+            std::cout << "Error during computation: " << e.what() << std::endl;
+            evaluated = false;
+        }
+        while (evaluated && std::abs(y_x) >= tolerance && count < max_iterations) {
+            count++;
+            try {
+                // (f(x + f(x)) - f(x)) / f(x) takes the place of the derivative
+                double fx1 = y_x;
+                double fxf = func.evaluate(x1 + fx1);
+                double denominator = fxf - fx1;
+                
+                if (std::abs(denominator) < 1e-10) {
+                    std::cout << "Division by near-zero value. Method failed to converge." << std::endl;
+                    break;
+                }
+                
+                // Formula of Steffensen's method
+                x2 = x1 - (fx1 * fx1) / denominator;
+
+                sleep_ms(200);
+                std::cout << std::endl << count << ") Iteration: " << "\t";
+                std::cout << "x" << count-1 << " = " << std::fixed << std::setprecision(4) << x1 
+                          << "\t f(x" << count-1 << ") = " << std::fixed << std::setprecision(4) << fx1 
+                          << "\t f(x" << count-1 << " + f(x" << count-1 << ")) = " << std::fixed << std::setprecision(4) << fxf << std::endl;
+                std::cout << "x" << count << " = " << std::fixed << std::setprecision(4) << x2 << std::endl;
+
+                // Updating values
+                x1 = x2;
+                y_x = func.evaluate(x1);
+                
+            } catch (const std::exception& e) {
+                std::cout << "Error during computation: " << e.what() << std::endl;
+                break;
+            }
+        }
+
+        std::cout << std::endl << "Number of Iterations = " << count << std::endl;
+        if (count >= max_iterations) {
+            std::cout << "Maximum iterations reached, solution may not be accurate." << std::endl;
+        }
+        std::cout << "By Steffensen's Method, x" << count << " = " << std::fixed << std::setprecision(4) << x2 << " (approximately)";
+    }
+};
+
+class HalleyMethod {
+    double x1, x2;
+    double y_x = std::numeric_limits<double>::max();
+    double derivatives[4];
+    FunctionManager& func;
+    double tolerance;
+    int max_iterations;
+
+public: 
+    HalleyMethod(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
+        : func(f), tolerance(tol), max_iterations(max_iter) {
+        
+        sleep_ms(500);
+        std::cout << std::endl << "Enter the first approximate value: ";
+        std::cin >> x1;
+        x2 = x1;
+
+        int count = 0;
+        bool evaluated = true;
+        try {
+            // f and its derivatives come from one pass over the compiled expression
+            func.evaluateWithDerivatives(x1, derivatives);
+            y_x = derivatives[0];
+        } catch (const std::exception& e) {
+            std::cout << "Error during computation: " << e.what() << std::endl;
+            evaluated = false;
+        }
+        while (evaluated && std::abs(y_x) >= tolerance && count < max_iterations) {
+            count++;
+            try {
+                double fx1 = derivatives[0];
+                double dfx1 = derivatives[1];
+                double d2fx1 = derivatives[2];
+                double denominator = 2 * dfx1 * dfx1 - fx1 * d2fx1;
+                
+                if (std::abs(denominator) < 1e-10) {
+                    std::cout << "Division by near-zero value. Method failed to converge." << std::endl;
+                    break;
+                }
+                
+                // Formula of Halley's method
+                x2 = x1 - (2 * fx1 * dfx1) / denominator;
+
+                sleep_ms(200);
+                std::cout << std::endl << count << ") Iteration: " << "\t";
+                std::cout << "x" << count-1 << " = " << std::fixed << std::setprecision(4) << x1 
+                          << "\t f(x" << count-1 << ") = " << std::fixed << std::setprecision(4) << fx1 
+                          << "\t f'(x" << count-1 << ") = " << std::fixed << std::setprecision(4) << dfx1 
+                          << "\t f''(x" << count-1 << ") = " << std::fixed << std::setprecision(4) << d2fx1 << std::endl;
+                std::cout << "x" << count << " = " << std::fixed << std::setprecision(4) << x2 << std::endl;
+
+                // Updating values
+                x1 = x2;
+                func.evaluateWithDerivatives(x1, derivatives);
+                y_x = derivatives[0];
+                
+            } catch (const std::exception& e) {
+                std::cout << "Error during computation: " << e.what() << std::endl;
+                break;
+            }
+        }
+
+        std::cout << std::endl << "Number of Iterations = " << count << std::endl;
+        if (count >= max_iterations) {
+            std::cout << "Maximum iterations reached, solution may not be accurate." << std::endl;
+        }
+        std::cout << "By Halley's Method, x" << count << " = " << std::fixed << std::setprecision(4) << x2 << " (approximately)";
+    }
+};
+
+class HouseholderMethod {
+    double x1, x2;
+    double y_x = std::numeric_limits<double>::max();
+    double derivatives[4];
+    FunctionManager& func;
+    double tolerance;
+    int max_iterations;
+
+public: 
+    HouseholderMethod(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
+        : func(f), tolerance(tol), max_iterations(max_iter) {
+        
+        sleep_ms(500);
+        std::cout << std::endl << "Enter the first approximate value: ";
+        std::cin >> x1;
+        x2 = x1;
+
+        int count = 0;
+        bool evaluated = true;
+        try {
+            // f and its derivatives come from one pass over the compiled expression
+            func.evaluateWithDerivatives(x1, derivatives);
+            y_x = derivatives[0];
+        } catch (const std::exception& e) {
+            std::cout << "Error during computation: " << e.what() << std::endl;
+            evaluated = false;
+        }
+        while (evaluated && std::abs(y_x) >= tolerance && count < max_iterations) {
+            count++;
+            try {
+                double fx1 = derivatives[0];
+                double dfx1 = derivatives[1];
+                double d2fx1 = derivatives[2];
+                double d3fx1 = derivatives[3];
+                double numerator = 6 * fx1 * dfx1 * dfx1 - 3 * fx1 * fx1 * d2fx1;
+                double denominator = 6 * dfx1 * dfx1 * dfx1 - 6 * fx1 * dfx1 * d2fx1 + fx1 * fx1 * d3fx1;
+                
+                if (std::abs(denominator) < 1e-10) {
+                    std::cout << "Division by near-zero value. Method failed to converge." << std::endl;
+                    break;
+                }
+                
+                // Formula of Householder's third order method
+                x2 = x1 - numerator / denominator;
+
+                sleep_ms(200);
+                std::cout << std::endl << count << ") Iteration: " << "\t";
+                std::cout << "x" << count-1 << " = " << std::fixed << std::setprecision(4) << x1 
+                          << "\t f(x" << count-1 << ") = " << std::fixed << std::setprecision(4) << fx1 
+                          << "\t f'(x" << count-1 << ") = " << std::fixed << std::setprecision(4) << dfx1 
+                          << "\t f''(x" << count-1 << ") = " << std::fixed << std::setprecision(4) << d2fx1 
+                          << "\t f'''(x" << count-1 << ") = " << std::fixed << std::setprecision(4) << d3fx1 << std::endl;
+                std::cout << "x" << count << " = " << std::fixed << std::setprecision(4) << x2 << std::endl;
+
+                // Updating values
+                x1 = x2;
+                func.evaluateWithDerivatives(x1, derivatives);
+                y_x = derivatives[0];
+                
+            } catch (const std::exception& e) {
+                std::cout << "Error during computation: " << e.what() << std::endl;
+                break;
+            }
+        }
+
+        std::cout << std::endl << "Number of Iterations = " << count << std::endl;
+        if (count >= max_iterations) {
+            std::cout << "Maximum iterations reached, solution may not be accurate." << std::endl;
+        }
+        std::cout << "By Householder's Method, x" << count << " = " << std::fixed << std::setprecision(4) << x2 << " (approximately)";
+    }
+};
+
+class AitkenAcceleration {
+    double a, b, c;
+    double y_c = std::numeric_limits<double>::max();
+    std::vector<double> sequence;
+    FunctionManager& func;
+    double tolerance;
+    int max_iterations;
+
+public: 
+    AitkenAcceleration(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
+        : func(f), tolerance(tol), max_iterations(max_iter) {
+        
+        // Choose the sequence to accelerate
+        int base_method;
+        std::cout << std::endl << "Sequence to accelerate:" << std::endl;
+        std::cout << "1. Regula Falsi Method" << std::endl;
+        std::cout << "2. Secant Method" << std::endl;
+        std::cout << "Choose: ";
+        std::cin >> base_method;
+        bool bracketed = (base_method == 1);
+        
+        std::cout << "Enter two initial approximations:" << std::endl;
+        std::cout << "First approximation (a): ";
+        std::cin >> a;
+        std::cout << "Second approximation (b): ";
+        std::cin >> b;
+        
+        // f(a) and f(b) are carried along with the end points instead of re-evaluated each iteration
+        double fa, fb;
+        try {
+            fa = func.evaluate(a);
+            fb = func.evaluate(b);
+        } catch (const std::exception& e) {
+            std::cout << "Error during computation: " << e.what() << std::endl;
+            return;
+        }
+        
+        if (bracketed && fa * fb > 0) {
+            std::cout << "Warning: Function does not change sign between a and b." << std::endl;
+            std::cout << "The method may not converge." << std::endl;
+        }
+        
+        sleep_ms(500);
+        std::cout << std::endl << "Starting with initial values (" << std::fixed << std::setprecision(4) << a 
+                  << ", " << std::fixed << std::setprecision(4) << b << ")" << std::endl << std::endl;
+
+        int count = 0;
+        c = b;
+        while (std::abs(y_c) >= tolerance && count < max_iterations) {
+            count++;
+            try {
+                if (std::abs(fb - fa) < 1e-10) {
+                    std::cout << "Division by near-zero value. Method failed to converge." << std::endl;
+                    break;
+                }
+                
+                double x = ((a * fb) - (b * fa)) / (fb - fa);
+                double y_x = func.evaluate(x);
+                sequence.push_back(x);
+                
+                // Aitken's delta-squared on the last three terms of the sequence
+                c = x;
+                y_c = y_x;
+                bool accelerated = false;
+                size_t n = sequence.size();
+                if (n >= 3) {
+                    double s0 = sequence[n - 3], s1 = sequence[n - 2], s2 = sequence[n - 1];
+                    double denominator = s2 - 2 * s1 + s0;
+                    double x_acc = s2 - ((s2 - s1) * (s2 - s1)) / denominator;
+                    bool inside = !bracketed || (x_acc > std::min(a, b) && x_acc < std::max(a, b));
+                    if (std::abs(denominator) > 1e-12 && std::isfinite(x_acc) && inside) {
+                        // An accepted accelerated point becomes the next iterate, so its evaluation is not wasted
+                        double y_acc = func.evaluate(x_acc);
+                        if (std::abs(y_acc) < std::abs(y_x)) {
+                            c = x_acc;
+                            y_c = y_acc;
+                            accelerated = true;
+                        }
+                    }
+                    // Restart the sequence from the current iterate
+                    sequence.assign(1, c);
+                }
+                
+                sleep_ms(200);
+                std::cout << std::endl << count << ") Iteration: " << std::endl;
+                std::cout << "x" << count << " = " << std::fixed << std::setprecision(4) << x 
+                          << "\t f(x" << count << ") = " << std::fixed << std::setprecision(4) << y_x << std::endl;
+                if (accelerated) {
+                    std::cout << "Accelerated x" << count << " = " << std::fixed << std::setprecision(4) << c 
+                              << "\t f = " << std::fixed << std::setprecision(4) << y_c << std::endl;
+                }
+
+                // Updating the values of x:
+                if (bracketed) {
+                    if (y_c * fa < 0) {
+                        b = c;
+                        fb = y_c;
+                    } else {
+                        a = c;
+                        fa = y_c;
+                    }
+                } else {
+                    a = b;
+                    fa = fb;
+                    b = c;
+                    fb = y_c;
+                }
+                
+            } catch (const std::exception& e) {
+                std::cout << "Error during computation: " << e.what() << std::endl;
+                break;
+            }
+        } 
+
+        std::cout << std::endl << "Number of Iterations = " << count << std::endl;
+        if (count >= max_iterations) {
+            std::cout << "Maximum iterations reached, solution may not be accurate." << std::endl;
+        }
+        std::cout << "By Aitken's Delta-Squared Acceleration, x = " << std::fixed << std::setprecision(4) << c << " (approximately)";
+    }
+};
+
+class ContinuationMethod {
+    std::vector<double> t_values, roots;
+    double t_start, t_end, step;
+    FunctionManager& func;
+    double tolerance;
+    int max_iterations;
+    int max_corrector_iterations = 5;
+
+public: 
+    ContinuationMethod(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
+        : func(f), tolerance(tol), max_iterations(max_iter) {
+        
+        // The function is f(x, t), solved for x along a range of t
+        std::cout << std::endl << "Enter parameter range for t:" << std::endl;
+        std::cout << "Start value: ";
+        std::cin >> t_start;
+        std::cout << "End value: ";
+        std::cin >> t_end;
+        std::cout << "Initial step size: ";
+        std::cin >> step;
+        std::cout << "Approximate root at t = " << std::fixed << std::setprecision(4) << t_start << ": ";
+        double x0;
+        std::cin >> x0;
+        
+        step = std::abs(step);
+        if (step == 0) {
+            step = std::abs(t_end - t_start) / 10;
+        }
+        double direction = (t_end >= t_start) ? 1.0 : -1.0;
+        double initial_step = step;
+        double max_step = std::abs(t_end - t_start);
+        double min_step = step / 1024;
+
+        // Solve the first problem from the user's guess
+        double x, dfx;
+        int iterations;
+        if (!correct(x0, t_start, max_iterations, x, dfx, iterations)) {
+            std::cout << "Failed to solve at t = " << std::fixed << std::setprecision(4) << t_start 
+                      << ". Try a different approximate root." << std::endl;
+            return;
+        }
+        t_values.push_back(t_start);
+        roots.push_back(x);
+        int total_iterations = iterations;
+        
+        sleep_ms(500);
+        std::cout << std::endl << "t = " << std::fixed << std::setprecision(4) << t_start 
+                  << "\t x = " << std::fixed << std::setprecision(4) << x 
+                  << "\t (" << iterations << " iterations)" << std::endl;
+
+        int count = 0;
+        double t = t_start;
+        while (direction * (t_end - t) > 1e-12 && count < max_iterations) {
+            try {
+                double h = std::min(step, std::abs(t_end - t));
+                double t_new = t + direction * h;
+                double x_pred = predict(t_new, x, t, dfx);
+                double x_new, dfx_new;
+                
+                if (!correct(x_pred, t_new, max_corrector_iterations, x_new, dfx_new, iterations)) {
+                    // Reject the step and retry closer to the last solution
+                    step /= 2;
+                    if (step < min_step) {
+                        std::cout << std::endl << "Step size became too small near t = " << std::fixed << std::setprecision(4) << t << "." << std::endl;
+                        // A vanishing df/dx or a steep dx/dt = -(df/dt) / (df/dx) means the branch is turning back
+                        if (std::abs(dfx) < 1e-10 || std::abs(func.evaluateDerivativeT(x, t) / dfx) * initial_step > 1 + std::abs(x)) {
+                            std::cout << "df/dx is near zero, a turning point is likely." << std::endl;
+                        }
+                        break;
+                    }
+                    continue;
+                }
+                
+                // A sign change of df/dx means the branch folded back between the two values of t
+                if (dfx * dfx_new < 0) {
+                    std::cout << std::endl << "Turning point detected between t = " << std::fixed << std::setprecision(4) << t 
+                              << " and t = " << std::fixed << std::setprecision(4) << t_new << "." << std::endl;
+                    break;
+                }
+                
+                // Only accepted steps count against the maximum
+                count++;
+                total_iterations += iterations;
+                t = t_new;
+                x = x_new;
+                dfx = dfx_new;
+                t_values.push_back(t);
+                roots.push_back(x);
+
+                sleep_ms(200);
+                std::cout << "t = " << std::fixed << std::setprecision(4) << t 
+                          << "\t predicted x = " << std::fixed << std::setprecision(4) << x_pred 
+                          << "\t x = " << std::fixed << std::setprecision(4) << x 
+                          << "\t (" << iterations << " iterations)" << std::endl;
+                
+                // Grow the step while the corrector converges quickly
+                if (iterations <= 2) {
+                    step = std::min(step * 1.5, max_step);
+                }
+                
+            } catch (const std::exception& e) {
+                std::cout << "Error during computation: " << e.what() << std::endl;
+                break;
+            }
+        }
+
+        std::cout << std::endl << "Number of Solves = " << roots.size() << std::endl;
+        std::cout << "Total Corrector Iterations = " << total_iterations << std::endl;
+        if (count >= max_iterations && direction * (t_end - t) > 1e-12) {
+            std::cout << "Maximum iterations reached, the end of the range may not be reached." << std::endl;
+        }
+        std::cout << "By Continuation, x = " << std::fixed << std::setprecision(4) << x 
+                  << " at t = " << std::fixed << std::setprecision(4) << t << " (approximately)";
+    }
+    
+private:
+    double predict(double t_new, double x, double t, double dfx) {
+        size_t n = roots.size();
+        if (n == 1) {
+            // Tangent predictor: dx/dt = -(df/dt) / (df/dx), or the previous root where df/dx vanishes
+            if (std::abs(dfx) < 1e-10) {
+                return x;
+            }
+            try {
+                double tangent = x - func.evaluateDerivativeT(x, t) / dfx * (t_new - t);
+                return std::isfinite(tangent) ? tangent : x;
+            } catch (const std::exception&) {
+                return x;
+            }
+        }
+        
+        // Polynomial extrapolation through the last (up to three) solutions
+        size_t k = std::min(n, (size_t)3);
+        double result = 0;
+        for (size_t i = n - k; i < n; i++) {
+            double weight = 1;
+            for (size_t j = n - k; j < n; j++) {
+                if (j != i) {
+                    weight *= (t_new - t_values[j]) / (t_values[i] - t_values[j]);
+                }
+            }
+            result += weight * roots[i];
+        }
+        return std::isfinite(result) ? result : roots.back();
+    }
+    
+    bool correct(double x0, double t, int limit, double& x, double& dfx, int& iterations) {
+        // Newton-Raphson in x with t held fixed
+        x = x0;
+        iterations = 0;
+        try {
+            double fx = func.evaluate(x, t);
+            dfx = func.evaluateDerivativeX(x, t);
+            while (true) {
+                // A NaN or infinite value is a failed correction, never a root
+                if (!std::isfinite(x) || !std::isfinite(fx) || !std::isfinite(dfx)) {
+                    return false;
+                }
+                if (std::abs(fx) < tolerance) {
+                    return true;
+                }
+                if (iterations >= limit || std::abs(dfx) < 1e-10) {
+                    return false;
+                }
+                iterations++;
+                x = x - (fx / dfx);
+                fx = func.evaluate(x, t);
+                dfx = func.evaluateDerivativeX(x, t);
+            }
+        } catch (const std::exception&) {
+            // A domain error (e.g. the predictor overshooting out of sqrt's domain) also fails the correction
+            return false;
+        }
+    }
+};
+
+class ChebyshevProxy {
+    double a, b;
+    std::vector<double> samples;
+    std::vector<double> coefficients;
+    std::vector<double> derivative_coefficients;
+    std::vector<double> roots;
+    int evaluations = 0;
+    int max_degree = 1024;
+    FunctionManager& func;
+    double tolerance;
+    int max_iterations;
+
+public: 
+    ChebyshevProxy(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
+        : func(f), tolerance(tol), max_iterations(max_iter) {
+        
+        // Ask user for the interval to search
+        std::cout << std::endl << "Enter the interval to search for roots:" << std::endl;
+        std::cout << "Lower bound a: ";
+        std::cin >> a;
+        std::cout << "Upper bound b: ";
+        std::cin >> b;
+        if (a > b) {
+            std::swap(a, b);
+        }
+        
+        sleep_ms(500);
+        try {
+            if (!build()) {
+                std::cout << "Warning: Chebyshev coefficients did not decay by degree " << max_degree << "." << std::endl;
+                std::cout << "The function may not be smooth on the interval, roots may be missed." << std::endl;
+            }
+            int proxy_evaluations = evaluations;
+            std::cout << std::endl << "Chebyshev proxy of degree " << coefficients.size() - 1 
+                      << " built from " << proxy_evaluations << " function evaluations" << std::endl << std::endl;
+            
+            // Every sample was exactly zero, so every point of the interval is a root
+            if (coefficients.size() == 1 && coefficients[0] == 0) {
+                std::cout << "Function Evaluations = " << evaluations << std::endl;
+                std::cout << "By Chebyshev Proxy, f(x) = 0 on the whole interval (" << std::fixed << std::setprecision(4) << a 
+                          << ", " << std::fixed << std::setprecision(4) << b << ")";
+                return;
+            }
+
+            findProxyRoots();
+            differentiate();
+
+            // Polish each root with a few Newton-Raphson steps on the true function,
+            // taking f' from the proxy so each step costs a single evaluation of f
+            std::vector<double> polished;
+            for (size_t i = 0; i < roots.size(); i++) {
+                double x = roots[i];
+                double fx = func.evaluate(x);
+                evaluations++;
+                for (int step = 0; step < 3 && step < max_iterations && fx != 0; step++) {
+                    double dfx = proxyDerivative(x);
+                    if (std::abs(dfx) < 1e-10) {
+                        break;
+                    }
+                    double x_new = x - (fx / dfx);
+                    if (x_new < a || x_new > b) {
+                        break;
+                    }
+                    double fx_new = func.evaluate(x_new);
+                    evaluations++;
+                    if (std::abs(fx_new) > std::abs(fx)) {
+                        break;
+                    }
+                    x = x_new;
+                    fx = fx_new;
+                }
+                if (std::abs(fx) < tolerance && (polished.empty() || std::abs(x - polished.back()) > 1e-10 * (b - a))) {
+                    polished.push_back(x);
+                
+                    sleep_ms(200);
+                    std::cout << "Root " << polished.size() << ": x = " << std::fixed << std::setprecision(4) << x 
+                              << "\t f(x) = " << std::fixed << std::setprecision(4) << fx << std::endl;
+                }
+            }
+            roots = polished;
+        } catch (const std::exception& e) {
+            std::cout << "Error during computation: " << e.what() << std::endl;
+            return;
+        }
+
+        std::cout << std::endl << "Number of Roots = " << roots.size() << std::endl;
+        std::cout << "Function Evaluations = " << evaluations << std::endl;
+        std::cout << "By Chebyshev Proxy, " << roots.size() << " root(s) found in (" << std::fixed << std::setprecision(4) << a 
+                  << ", " << std::fixed << std::setprecision(4) << b << ")";
+    }
+    
+private:
+    double point(int j, int n) {
+        // Chebyshev points of the second kind mapped to [a, b]
+        return 0.5 * (a + b) + 0.5 * (b - a) * cos(pi * j / n);
+    }
+    
+    double sample(double x) {
+        double fx = func.evaluate(x);
+        evaluations++;
+        if (!std::isfinite(fx)) {
+            throw std::runtime_error("Function is not finite on the interval");
+        }
+        return fx;
+    }
+    
+    bool build() {
+        int n = 16;
+        samples.resize(n + 1);
+        for (int j = 0; j <= n; j++) {
+            samples[j] = sample(point(j, n));
+        }
+        
+        while (true) {
+            // Coefficients by the discrete cosine transform of the samples
+            std::vector<double> table(2 * n);
+            for (int m = 0; m < 2 * n; m++) {
+                table[m] = cos(pi * m / n);
+            }
+            coefficients.assign(n + 1, 0.0);
+            for (int k = 0; k <= n; k++) {
+                double sum = 0.5 * (samples[0] + samples[n] * ((k % 2 == 0) ? 1 : -1));
+                for (int j = 1; j < n; j++) {
+                    sum += samples[j] * table[(j * k) % (2 * n)];
+                }
+                coefficients[k] = 2.0 * sum / n;
+            }
+            coefficients[0] /= 2;
+            coefficients[n] /= 2;
+            
+            // Converged once the tail of the series is at rounding level
+            double scale = 0;
+            for (int j = 0; j <= n; j++) {
+                scale = std::max(scale, std::abs(samples[j]));
+            }
+            double cutoff = 1e-13 * std::max(scale, 1e-300);
+            bool converged = true;
+            for (int k = n - 2; k <= n; k++) {
+                if (std::abs(coefficients[k]) > cutoff) {
+                    converged = false;
+                }
+            }
+            if (converged || n >= max_degree) {
+                while (coefficients.size() > 1 && std::abs(coefficients.back()) <= cutoff) {
+                    coefficients.pop_back();
+                }
+                return converged;
+            }
+            
+            // Double the degree, the old points are every other new point
+            std::vector<double> refined(2 * n + 1);
+            for (int j = 0; j <= 2 * n; j++) {
+                refined[j] = (j % 2 == 0) ? samples[j / 2] : sample(point(j, 2 * n));
+            }
+            samples = refined;
+            n *= 2;
+        }
+    }
+    
+    double clenshaw(const std::vector<double>& series, double s) {
+        // Clenshaw recurrence for a Chebyshev series at s in [-1, 1]
+        double b1 = 0, b2 = 0;
+        for (size_t k = series.size() - 1; k >= 1; k--) {
+            double b0 = series[k] + 2 * s * b1 - b2;
+            b2 = b1;
+            b1 = b0;
+        }
+        return series[0] + s * b1 - b2;
+    }
+    
+    double proxy(double s) {
+        return clenshaw(coefficients, s);
+    }
+    
+    void differentiate() {
+        // Coefficients of the derivative series, from d(k-1) = d(k+1) + 2k c(k)
+        size_t n = coefficients.size() - 1;
+        std::vector<double> d(n + 2, 0.0);
+        for (size_t k = n; k >= 1; k--) {
+            d[k - 1] = d[k + 1] + 2 * k * coefficients[k];
+        }
+        d[0] /= 2;
+        d.resize(std::max(n, (size_t)1));
+        derivative_coefficients = d;
+    }
+    
+    double proxyDerivative(double x) {
+        // f'(x) of the proxy, scaled from [-1, 1] back to [a, b]
+        double s = (2 * x - a - b) / (b - a);
+        return clenshaw(derivative_coefficients, s) * 2 / (b - a);
+    }
+    
+    void findProxyRoots() {
+        // Scan the proxy on a grid finer than its degree, then bisect each sign change
+        int degree = (int)coefficients.size() - 1;
+        int m = std::max(4 * degree, 64);
+        std::vector<double> s(m + 1), p(m + 1);
+        for (int i = 0; i <= m; i++) {
+            s[i] = -cos(pi * i / m);
+            p[i] = proxy(s[i]);
+        }
+        
+        for (int i = 0; i <= m; i++) {
+            double root;
+            if (p[i] == 0) {
+                root = s[i];
+            } else if (i < m && p[i] * p[i + 1] < 0) {
+                double lo = s[i], hi = s[i + 1], p_lo = p[i];
+                for (int k = 0; k < 60 && hi - lo > 1e-15; k++) {
+                    double mid = 0.5 * (lo + hi);
+                    double p_mid = proxy(mid);
+                    if (p_mid == 0) {
+                        lo = hi = mid;
+                    } else if (p_lo * p_mid < 0) {
+                        hi = mid;
+                    } else {
+                        lo = mid;
+                        p_lo = p_mid;
+                    }
+                }
+                root = 0.5 * (lo + hi);
+            } else if (i > 0 && i < m && std::abs(p[i]) <= std::abs(p[i - 1]) && std::abs(p[i]) <= std::abs(p[i + 1])
+                       && p[i] * p[i - 1] > 0 && p[i] * p[i + 1] > 0) {
+                // A touching (double) root does not change sign, look for a minimum of |p| near zero
+                double lo = s[i - 1], hi = s[i + 1];
+                for (int k = 0; k < 100 && hi - lo > 1e-15; k++) {
+                    double m1 = lo + (hi - lo) / 3, m2 = hi - (hi - lo) / 3;
+                    if (std::abs(proxy(m1)) < std::abs(proxy(m2))) {
+                        hi = m2;
+                    } else {
+                        lo = m1;
+                    }
+                }
+                root = 0.5 * (lo + hi);
+                if (std::abs(proxy(root)) >= tolerance) {
+                    continue;
+                }
+            } else {
+                continue;
+            }
+            roots.push_back(0.5 * (a + b) + 0.5 * (b - a) * root);
+        }
+        std::sort(roots.begin(), roots.end());
+    }
+};
+
+class BatchSolver {
+    double start, end, step;
+    int threads;
+    std::vector<double> roots;
+    int total_iterations = 0;
+    FunctionManager& func;
+    double tolerance;
+    int max_iterations;
+    
+    // Subintervals per chunk. Fixed so the partitioning never depends on the thread count.
+    static const long chunk_size = 64;
+
+    struct ChunkResult {
+        std::vector<double> roots;
+        int iterations = 0;
+        std::string error;
+    };
+
+public: 
+    BatchSolver(FunctionManager& f, double tol = 0.0001, int max_iter = 100) 
+        : func(f), tolerance(tol), max_iterations(max_iter) {
+        
+        // Ask user for search range and threads
+        std::cout << "Enter search range for roots:" << std::endl;
+        std::cout << "Start value: ";
+        std::cin >> start;
+        std::cout << "End value: ";
+        std::cin >> end;
+        std::cout << "Step size: ";
+        std::cin >> step;
+        std::cout << "Number of threads [0 = automatic]: ";
+        std::cin >> threads;
+        
+        long intervals = (step > 0) ? (long)std::floor((end - start) / step + 1e-9) : 0;
+        if (intervals <= 0) {
+            std::cout << "The search range must contain at least one step." << std::endl;
+            return;
+        }
+        long chunks = (intervals + chunk_size - 1) / chunk_size;
+        if (threads <= 0) {
+            threads = std::max(1, (int)std::thread::hardware_concurrency());
+        }
+        threads = (int)std::min((long)threads, chunks);
+
+        // Chunk c always goes to thread c % threads and writes only its own slot
+        std::vector<ChunkResult> results(chunks);
+        std::vector<std::thread> workers;
+        for (int w = 1; w < threads; w++) {
+            workers.push_back(std::thread(&BatchSolver::worker, this, w, intervals, std::ref(results)));
+        }
+        worker(0, intervals, results);
+        for (size_t w = 0; w < workers.size(); w++) {
+            workers[w].join();
+        }
+
+        // Reduce in chunk order so the output does not depend on scheduling
+        std::vector<double> found;
+        for (long c = 0; c < chunks; c++) {
+            if (!results[c].error.empty()) {
+                std::cout << results[c].error << std::endl;
+            }
+            found.insert(found.end(), results[c].roots.begin(), results[c].roots.end());
+            total_iterations += results[c].iterations;
+        }
+        
+        // Brackets are in increasing order, so duplicates are always neighbours
+        for (size_t i = 0; i < found.size(); i++) {
+            if (roots.empty() || std::abs(found[i] - roots.back()) > 1e-9 * (1 + std::abs(found[i]))) {
+                roots.push_back(found[i]);
+            }
+        }
+
+        sleep_ms(500);
+        std::cout << std::endl;
+        for (size_t i = 0; i < roots.size(); i++) {
+            sleep_ms(200);
+            std::cout << "Root " << i + 1 << ": x = " << std::fixed << std::setprecision(4) << roots[i] << std::endl;
+        }
+
+        std::cout << std::endl << "Threads Used = " << threads << std::endl;
+        std::cout << "Number of Roots = " << roots.size() << std::endl;
+        std::cout << "Total Iterations = " << total_iterations << std::endl;
+        std::cout << "By Batch Regula Falsi, " << roots.size() << " root(s) found in (" << std::fixed << std::setprecision(4) << start 
+                  << ", " << std::fixed << std::setprecision(4) << end << ")";
+    }
+    
+    const std::vector<double>& getRoots() const {
+        return roots;
+    }
+    
+    int getIterations() const {
+        return total_iterations;
+    }
+    
+private:
+    void worker(int w, long intervals, std::vector<ChunkResult>& results) {
+        for (long c = w; c < (long)results.size(); c += threads) {
+            long first = c * chunk_size;
+            long last = std::min(first + chunk_size, intervals);
+            for (long i = first; i < last; i++) {
+                try {
+                    solveBracket(i, intervals, results[c]);
+                } catch (const std::exception& e) {
+                    if (results[c].error.empty()) {
+                        std::ostringstream message;
+                        message << "Error evaluating function near x = " << std::fixed << std::setprecision(4) 
+                                << start + i * step << ": " << e.what();
+                        results[c].error = message.str();
+                    }
+                }
+            }
+        }
+    }
+    
+    void solveBracket(long i, long intervals, ChunkResult& result) {
+        // Bracket ends come from the index, never from a running sum
+        double a = start + i * step;
+        double b = start + (i + 1) * step;
+        double fa = func.evaluate(a);
+        double fb = func.evaluate(b);
+        
+        // A root exactly on a shared end belongs to the bracket on its right
+        if (fa == 0) {
+            result.roots.push_back(a);
+            return;
+        }
+        if (fb == 0) {
+            if (i == intervals - 1) {
+                result.roots.push_back(b);
+            }
+            return;
+        }
+        if (fa * fb > 0) {
+            return;
+        }
+        
+        // Regula Falsi inside the bracket
+        double c = a, fc = fa;
+        int count = 0;
+        while (std::abs(fc) >= tolerance && count < max_iterations) {
+            count++;
+            c = ((a * fb) - (b * fa)) / (fb - fa);
+            fc = func.evaluate(c);
+            if (fc * fa < 0) {
+                b = c;
+                fb = fc;
+            } else {
+                a = c;
+                fa = fc;
+            }
+        }
+        result.roots.push_back(c);
+        result.iterations += count;
+    }
+};
+
+// Golden corpus: expected results of the classic methods, checked with --verify
+struct GoldenCase {
+    const char* expression;
+    int method;
+    const char* input;
+    double root;
+    int iterations;
+};
+
+const GoldenCase golden_corpus[] = {
+    {"x^2-4", 1, "0\n5\n1\n", 2, 1},
+    {"x^2-4", 2, "1\n3\n", 1.99999995786008, 5},
+    {"x^2-4", 3, "1\n", 2.0000000929223, 4},
+    {"x^2-4", 4, "1\n1.5\n3\n", 2, 1},
+    {"x^3-2*x-5", 1, "0\n5\n1\n", 2.09454695087426, 10},
+    {"x^3-2*x-5", 2, "2\n3\n", 2.09454943103525, 4},
+    {"x^3-2*x-5", 3, "2\n", 2.09455148169821, 3},
+    {"x^3-2*x-5", 4, "1.5\n2\n2.5\n", 2.09454462182148, 2},
+    {"x*log10(x)-1.2", 1, "1\n5\n1\n", 2.74063625664312, 3},
+    {"x*log10(x)-1.2", 2, "2\n3\n", 2.74064688473748, 3},
+    {"x*log10(x)-1.2", 3, "2\n", 2.74064611548425, 3},
+    {"x*log10(x)-1.2", 4, "2\n2.5\n3\n", 2.74064568687638, 2},
+    {"exp(x)-3*x", 1, "1\n2\n0.25\n", 1.51211493120531, 5},
+    {"exp(-x)-x", 1, "0\n1\n0.5\n", 0.567204223988494, 2},
+    {"exp(-x)-x", 2, "0\n1\n", 0.567170358419745, 3},
+    {"exp(-x)-x", 3, "0\n", 0.567143165034344, 3},
+    {"exp(-x)-x", 4, "0\n0.5\n1\n", 0.56714161749932, 2},
+    {"sin(x)+cos(x)-0.5", 2, "1\n2\n", 1.99482489496959, 2},
+    {"sin(x)+cos(x)-0.5", 3, "2\n", 1.99483236683568, 1},
+    {"x-cos(x)", 1, "0\n1\n0.5\n", 0.73905073111472, 3},
+    {"x-cos(x)", 4, "0\n0.5\n1\n", 0.739074942419955, 2},
+    {"if(x<1, x^2, 2*x-1)-3", 1, "0\n4\n1\n", 2, 1},
+    {"if(x<1, x^2, 2*x-1)-3", 3, "0.5\n", 2.00000000000264, 2},
+    {"k=2; sq(u)=u*u; sq(x)-k", 2, "1\n2\n", 1.41421143847487, 4},
+    {"k=2; sq(u)=u*u; sq(x)-k", 4, "1\n1.2\n2\n", 1.41421356237309, 1}
+};
+
+// Runs a method on canned input with its output discarded
+// Feeds a method its answers and swallows its output, restoring the console streams even if it throws
+class QuietConsole {
+    std::istringstream in;
+    std::ostringstream out;
+    std::streambuf* old_in;
+    std::streambuf* old_out;
+    std::ios::fmtflags old_flags;
+    std::streamsize old_precision;
+
+public:
+    QuietConsole(const std::string& input) : in(input) {
+        old_in = std::cin.rdbuf(in.rdbuf());
+        old_out = std::cout.rdbuf(out.rdbuf());
+        old_flags = std::cout.flags();
+        old_precision = std::cout.precision();
+    }
+    
+    ~QuietConsole() {
+        std::cin.rdbuf(old_in);
+        std::cout.rdbuf(old_out);
+        std::cout.flags(old_flags);
+        std::cout.precision(old_precision);
+    }
+};
+
+template <typename Method>
+void runQuietly(FunctionManager& func, const std::string& input, double& root, int& iterations) {
+    QuietConsole console(input);
+    Method method(func, 0.0001, 100);
+    root = method.getRoot();
+    iterations = method.getIterations();
+}
+
+bool verifyGoldenCorpus() {
+    animations_enabled = false;
+    int failures = 0;
+    std::cout << std::setprecision(12);
+
+    for (size_t i = 0; i < sizeof(golden_corpus) / sizeof(golden_corpus[0]); i++) {
+        const GoldenCase& test = golden_corpus[i];
+        FunctionManager func;
+        double root = 0;
+        int iterations = 0;
+        std::string error;
+        try {
+            if (!func.setExpression(test.expression)) {
+                error = "failed to parse";
+            } else if (test.method == 1) {
+                runQuietly<RegulaFalsi>(func, test.input, root, iterations);
+            } else if (test.method == 2) {
+                runQuietly<SecantMethod>(func, test.input, root, iterations);
+            } else if (test.method == 3) {
+                runQuietly<NewtonRaphson>(func, test.input, root, iterations);
+            } else {
+                runQuietly<MullersMethod>(func, test.input, root, iterations);
+            }
+        } catch (const std::exception& e) {
+            error = e.what();
+        }
+        
+        bool passed = error.empty() && iterations == test.iterations
+                      && std::abs(root - test.root) <= 1e-9 * (1 + std::abs(test.root));
+        if (!passed) {
+            failures++;
+            std::cout << "FAIL method " << test.method << " f(x) = " << test.expression;
+            if (!error.empty()) {
+                std::cout << ": " << error << std::endl;
+            } else {
+                std::cout << ": got x = " << root << " in " << iterations << " iterations, expected x = " 
+                          << test.root << " in " << test.iterations << " iterations" << std::endl;
+            }
+        }
+    }
+
+    // Batch solving must give bit-identical roots for any number of threads
+    const char* batch_expression = "sin(10*x) + 0.5*x";
+    std::vector<double> reference;
+    const int thread_counts[] = {1, 2, 3, 8};
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+        FunctionManager func;
+        func.setExpression(batch_expression);
+        std::ostringstream input;
+        input << "-5 5 0.01 " << thread_counts[i] << "\n";
+        std::vector<double> found;
+        try {
+            QuietConsole console(input.str());
+            BatchSolver batch(func, 0.0001, 100);
+            found = batch.getRoots();
+        } catch (const std::exception& e) {
+            failures++;
+            std::cout << "FAIL batch f(x) = " << batch_expression << ": " << e.what() << std::endl;
+            continue;
+        }
+        
+        if (i == 0) {
+            reference = found;
+        } else if (found.size() != reference.size()
+                   || (!found.empty() && std::memcmp(&found[0], &reference[0], found.size() * sizeof(double)) != 0)) {
+            failures++;
+            std::cout << "FAIL batch f(x) = " << batch_expression << ": " << thread_counts[i] 
+                      << " threads differ from 1 thread" << std::endl;
+        }
+    }
+    if (reference.size() != 13) {
+        failures++;
+        std::cout << "FAIL batch f(x) = " << batch_expression << ": found " << reference.size() << " roots, expected 13" << std::endl;
+    }
+
+    if (failures == 0) {
+        std::cout << "All golden corpus checks passed" << std::endl;
+    } else {
+        std::cout << "Golden corpus checks failed: " << failures << std::endl;
+    }
+    return failures == 0;
+}
+
+// Display a stylish ASCII art banner
+void displayBanner() {
+    std::cout << "\n";
+    std::cout << " ╔════════════════════════════════════════════════════════════════╗\n";
+    std::cout << " ║                                                                ║\n";
+    std::cout << " ║  ███╗   ██╗██╗   ██╗███╗   ███╗███████╗██████╗ ██╗ ██████╗    ║\n";
+    std::cout << " ║  ████╗  ██║██║   ██║████╗ ████║██╔════╝██╔══██╗██║██╔════╝    ║\n";
+    std::cout << " ║  ██╔██╗ ██║██║   ██║██╔████╔██║█████╗  ██████╔╝██║██║         ║\n";
+    std::cout << " ║  ██║╚██╗██║██║   ██║██║╚██╔╝██║██╔══╝  ██╔══██╗██║██║         ║\n";
+    std::cout << " ║  ██║ ╚████║╚██████╔╝██║ ╚═╝ ██║███████╗██║  ██║██║╚██████╗    ║\n";
+    std::cout << " ║  ╚═╝  ╚═══╝ ╚═════╝ ╚═╝     ╚═╝╚══════╝╚═╝  ╚═╝╚═╝ ╚═════╝    ║\n";
+    std::cout << " ║                                                                ║\n";
+    std::cout << " ║              METHODS CALCULATOR                               ║\n";
     std::cout << " ║                                                                ║\n";
     std::cout << " ║             Author: Prathamesh Khade                          ║\n";
     std::cout << " ║                                                                ║\n";
@@ -654,7 +2423,12 @@ void displayBanner() {
 }
 
 // Main program
-int main() {
+int main(int argc, char* argv[]) {
+    // Non-interactive check of the golden corpus
+    if (argc > 1 && std::string(argv[1]) == "--verify") {
+        return verifyGoldenCorpus() ? 0 : 1;
+    }
+    
     FunctionManager functionManager;
     double tolerance = 0.0001;
     int max_iterations = 100;
@@ -680,7 +2454,8 @@ int main() {
             std::string expression;
             std::cout << std::endl << "Enter the function f(x) expression:" << std::endl;
             std::cout << "Examples: x^2-4, sin(x)+cos(x), log(x)-1.2" << std::endl;
-            std::cout << "Supported functions: sin, cos, tan, exp, log, log10, sqrt, abs" << std::endl;
+            std::cout << "Supported functions: sin, cos, tan, exp, log, log10, sqrt, abs, min, max, atan2, pow, hypot, if" << std::endl;
+            std::cout << "Definitions go before the function, separated by ';' (e.g. k=2; sq(u)=u*u; sq(x)-k)" << std::endl;
             std::cout << "f(x) = ";
             std::getline(std::cin, expression);
             
@@ -694,7 +2469,7 @@ int main() {
         case 2: {
             std::string filename;
             std::cout << std::endl << "Enter the path to the function file:" << std::endl;
-            std::cout << "(The file should contain a single line with the function expression)" << std::endl;
+            std::cout << "(The function expression goes on the last line; constants and helper functions may be defined on lines before it)" << std::endl;
             std::cout << "File path: ";
             std::getline(std::cin, filename);
             
@@ -735,6 +2510,13 @@ int main() {
     std::cout << "2. Secant Method" << std::endl;
     std::cout << "3. Newton Raphson Method" << std::endl;
     std::cout << "4. Muller's Method" << std::endl;
+    std::cout << "5. Steffensen's Method" << std::endl;
+    std::cout << "6. Halley's Method" << std::endl;
+    std::cout << "7. Householder's Method" << std::endl;
+    std::cout << "8. Aitken's Delta-Squared Acceleration" << std::endl;
+    std::cout << "9. Continuation over a parameter t" << std::endl;
+    std::cout << "10. Chebyshev Proxy (all roots in an interval)" << std::endl;
+    std::cout << "11. Batch Solve (all roots in a range, in parallel)" << std::endl;
     std::cout << "Choose: ";
     std::cin >> option;
 
@@ -760,6 +2542,41 @@ int main() {
                 break;
             }
             
+            case 5: {
+                SteffensenMethod st(functionManager, tolerance, max_iterations);
+                break;
+            }
+            
+            case 6: {
+                HalleyMethod h(functionManager, tolerance, max_iterations);
+                break;
+            }
+            
+            case 7: {
+                HouseholderMethod hh(functionManager, tolerance, max_iterations);
+                break;
+            }
+            
+            case 8: {
+                AitkenAcceleration ak(functionManager, tolerance, max_iterations);
+                break;
+            }
+            
+            case 9: {
+                ContinuationMethod cm(functionManager, tolerance, max_iterations);
+                break;
+            }
+            
+            case 10: {
+                ChebyshevProxy cp(functionManager, tolerance, max_iterations);
+                break;
+            }
+            
+            case 11: {
+                BatchSolver bs(functionManager, tolerance, max_iterations);
+                break;
+            }
+            
             default: {
                 std::cout << std::endl << "Choose correct option!!!";
                 break;